@@ -0,0 +1,23 @@
+# FetchContent_MakeAvailable was added in CMake 3.14
+cmake_minimum_required(VERSION 3.14)
+
+include(FetchContent)
+
+# stb has no release tags, pin a commit so that decoding is reproducible. Decoded images end up in
+# the cooked assets: magma-cook hashes this revision into its cache keys.
+set(MAGMA_STB_REVISION af1a5bc352164740c1cc1354942b1c6b72eacb8a)
+
+FetchContent_Declare(
+    stb
+    GIT_REPOSITORY  https://github.com/nothings/stb.git
+    GIT_TAG         ${MAGMA_STB_REVISION}
+)
+
+FetchContent_MakeAvailable(stb)
+
+# stb is a collection of single-file headers without any build system
+if(NOT TARGET stb::stb)
+    add_library(stb INTERFACE)
+    target_include_directories(stb SYSTEM INTERFACE ${stb_SOURCE_DIR})
+    add_library(stb::stb ALIAS stb)
+endif()
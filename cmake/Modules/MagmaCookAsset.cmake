@@ -0,0 +1,94 @@
+# Distributed under the MIT License.  See accompanying file License.txt for details.
+
+#[=======================================================================[.rst:
+MagmaCookAsset
+--------------
+
+.. contents::
+
+Overview
+^^^^^^^^
+
+This module enables the offline cooking of textures into asset packs using the ``magma-cook``
+tool. Each texture gets its full mip chain generated, is compressed to BC5 or BC7 (or stored
+uncompressed), and is laid out to be uploaded with a single ``vkCmdCopyBufferToImage`` call.
+The resulting asset pack is meant to be memory-mapped at runtime and read with
+``magma::asset::AssetPack``, leaving no decoding work to do at load time.
+
+Cooking is incremental: each cooked texture is cached by the hash of its content, so that only
+the textures actually modified are cooked again when the pack is rebuilt. Each pack has its own
+cache, from which the entries no longer referenced by the pack are removed.
+
+Commands
+^^^^^^^^
+
+Generating an asset pack
+""""""""""""""""""""""""
+
+.. command:: Magma_AddAssetPack
+
+  .. code-block:: cmake
+
+    Magma_AddAssetPack(<target>
+        [RGBA8 <textureFile>...]
+        [RGBA8_SRGB <textureFile>...]
+        [BC5 <textureFile>...]
+        [BC7 <textureFile>...]
+        [BC7_SRGB <textureFile>...]
+    )
+
+  The ``Magma_AddAssetPack()`` function adds a custom target called ``<target>`` cooking the
+  texture files listed in the command invocation into an asset pack, using the format given by
+  the keyword preceding them. The textures are named in the pack after their file name without
+  extension, which must thus be unique. The actual file name of the asset pack will be
+  ``<target>.assetpack`` and will be generated in ``PROJECT_BINARY_DIR`` folder.
+
+  .. code-block:: cmake
+
+    Magma_AddAssetPack(myAppAssets
+        BC7_SRGB textures/albedo.png textures/emissive.png
+        BC5 textures/normal.png
+    )
+
+#]=======================================================================]
+
+cmake_minimum_required(VERSION 3.20)
+
+function(_Magma_FindMagmaCook)
+    if(NOT TARGET Magma::magma-cook)
+        message(FATAL_ERROR "magma-cook not found (Magma must be built with MAGMA_ENABLE_TOOLS)")
+    endif()
+endfunction()
+
+function(Magma_AddAssetPack TARGET)
+    _Magma_FindMagmaCook()
+    set(FORMATS RGBA8 RGBA8_SRGB BC5 BC7 BC7_SRGB)
+    cmake_parse_arguments(PARSE_ARGV 1 ARG "" "" "${FORMATS}")
+    if(ARG_UNPARSED_ARGUMENTS)
+        message(FATAL_ERROR "Magma_AddAssetPack: unexpected arguments ${ARG_UNPARSED_ARGUMENTS}")
+    endif()
+    set(PACK_PATH "${PROJECT_BINARY_DIR}/${TARGET}.assetpack")
+    set(CACHE_PATH "${CMAKE_CURRENT_BINARY_DIR}/assets/${TARGET}.cache")
+    set(COOK_ARGS "")
+    set(TEXTURE_PATHS "")
+    foreach(FORMAT IN LISTS FORMATS)
+        if(NOT ARG_${FORMAT})
+            continue()
+        endif()
+        string(TOLOWER ${FORMAT} FORMAT_NAME)
+        string(REPLACE "_" "-" FORMAT_NAME ${FORMAT_NAME})
+        list(APPEND COOK_ARGS --format ${FORMAT_NAME})
+        foreach(TEXTURE IN LISTS ARG_${FORMAT})
+            cmake_path(ABSOLUTE_PATH TEXTURE OUTPUT_VARIABLE TEXTURE_PATH)
+            list(APPEND COOK_ARGS "${TEXTURE_PATH}")
+            list(APPEND TEXTURE_PATHS "${TEXTURE_PATH}")
+        endforeach()
+    endforeach()
+    add_custom_command(OUTPUT "${PACK_PATH}"
+        COMMAND Magma::magma-cook -o "${PACK_PATH}" --cache-dir "${CACHE_PATH}" ${COOK_ARGS}
+        DEPENDS Magma::magma-cook ${TEXTURE_PATHS}
+        COMMENT "Cooking asset pack ${TARGET}"
+        VERBATIM
+    )
+    add_custom_target(${TARGET} ALL DEPENDS "${PACK_PATH}")
+endfunction()
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <magma/asset/PackFormat.hpp>
+
+#include <magma/Vulkan.hpp>
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace magma::asset {
+
+/**
+ * @brief View over a texture stored in an asset pack
+ */
+struct Texture {
+    /**
+     * @brief Name of the texture in the pack
+     */
+    std::string_view name;
+    /**
+     * @brief Format to create the image with
+     */
+    vk::Format format;
+    /**
+     * @brief Extent of the first mip level
+     */
+    vk::Extent3D extent;
+    /**
+     * @brief Number of mip levels to create the image with
+     */
+    uint32_t mipLevels;
+    /**
+     * @brief Data of all the mip levels, to be copied as is into a staging buffer
+     */
+    std::span<const std::byte> data;
+    /**
+     * @brief Subresources of the texture, offsets relative to the start of data
+     */
+    std::span<const RegionEntry> regions;
+
+    /**
+     * @brief Builds the regions to pass to vkCmdCopyBufferToImage once data is copied at
+     * bufferOffset into a staging buffer
+     */
+    [[nodiscard]] std::vector<vk::BufferImageCopy> copyRegions(
+        vk::DeviceSize bufferOffset = 0) const;
+};
+
+/**
+ * @brief Read-only view over an asset pack produced by magma-cook
+ *
+ * The pack is used in place: the bytes given at construction (typically a memory-mapped file)
+ * must outlive this object and the textures obtained from it.
+ */
+class AssetPack {
+public:
+    /**
+     * @brief Validates the header and tables of the pack, throwing std::runtime_error if invalid
+     */
+    explicit AssetPack(std::span<const std::byte> bytes);
+
+    [[nodiscard]] std::size_t textureCount() const noexcept
+    {
+        return textures_.size();
+    }
+
+    /**
+     * @brief Returns the texture at index, throwing std::out_of_range if there is none
+     */
+    [[nodiscard]] Texture texture(std::size_t index) const;
+
+    /**
+     * @brief Returns the texture called name if any
+     */
+    [[nodiscard]] std::optional<Texture> findTexture(std::string_view name) const;
+
+private:
+    [[nodiscard]] std::string_view nameOf(const TextureEntry& entry) const;
+
+    std::span<const std::byte> bytes_;
+    std::span<const TextureEntry> textures_;
+    std::span<const RegionEntry> regions_;
+    std::span<const char> names_;
+};
+
+} // namespace magma::asset
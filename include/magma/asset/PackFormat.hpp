@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstdint>
+
+namespace magma::asset {
+
+/*
+ * On-disk layout of an asset pack as written by magma-cook.
+ *
+ * A pack is meant to be memory-mapped and used in place, without any parsing nor decoding:
+ *
+ *   PackHeader | TextureEntry[textureCount] | RegionEntry[regionCount] | names | texture data
+ *
+ * All offsets are in bytes, all integers are little-endian. The data of each texture starts on a
+ * dataAlignment boundary and holds every mip level, each one starting on a regionAlignment
+ * boundary, so that it can be copied as is into a staging buffer and uploaded with a single
+ * vkCmdCopyBufferToImage call.
+ */
+
+/**
+ * @brief Magic number identifying an asset pack ("MGPK")
+ */
+inline constexpr uint32_t packMagic = 0x4b50474d;
+
+/**
+ * @brief Version of the layout described in this file
+ */
+inline constexpr uint32_t packVersion = 1;
+
+/**
+ * @brief Alignment of the data of each texture, from the start of the pack
+ */
+inline constexpr uint64_t dataAlignment = 256;
+
+/**
+ * @brief Alignment of each region, from the start of the data of its texture
+ *
+ * Satisfies the bufferOffset requirements of vkCmdCopyBufferToImage for all the formats cooked
+ * (multiple of 4 and of the texel block size).
+ */
+inline constexpr uint64_t regionAlignment = 16;
+
+/**
+ * @brief Header located at the start of the pack
+ */
+struct PackHeader {
+    /**
+     * @brief Must be equal to packMagic
+     */
+    uint32_t magic;
+    /**
+     * @brief Must be equal to packVersion
+     */
+    uint32_t version;
+    /**
+     * @brief Number of TextureEntry following the header
+     */
+    uint32_t textureCount;
+    /**
+     * @brief Number of RegionEntry following the texture entries
+     */
+    uint32_t regionCount;
+    /**
+     * @brief Offset of the names, from the start of the pack
+     */
+    uint64_t namesOffset;
+    /**
+     * @brief Offset of the data of the first texture, from the start of the pack
+     */
+    uint64_t dataOffset;
+};
+static_assert(sizeof(PackHeader) == 32);
+
+/**
+ * @brief Description of a texture stored in the pack
+ */
+struct TextureEntry {
+    /**
+     * @brief Hash of the source file and cooking parameters the texture was built from
+     */
+    uint64_t contentHash;
+    /**
+     * @brief Offset of the data of the texture, from the start of the pack
+     */
+    uint64_t dataOffset;
+    /**
+     * @brief Size in bytes of the data of the texture, all mip levels included
+     */
+    uint64_t dataSize;
+    /**
+     * @brief Offset of the name of the texture, from the start of the names
+     */
+    uint32_t nameOffset;
+    /**
+     * @brief Size in bytes of the name of the texture, not null-terminated
+     */
+    uint32_t nameSize;
+    /**
+     * @brief VkFormat of the texture data
+     */
+    uint32_t format;
+    /**
+     * @brief Width in texels of the first mip level
+     */
+    uint32_t width;
+    /**
+     * @brief Height in texels of the first mip level
+     */
+    uint32_t height;
+    /**
+     * @brief Number of mip levels, which is also the number of regions of the texture
+     */
+    uint32_t mipLevels;
+    /**
+     * @brief Index of the first RegionEntry of the texture
+     */
+    uint32_t firstRegion;
+    /**
+     * @brief Number of RegionEntry of the texture
+     */
+    uint32_t regionCount;
+};
+static_assert(sizeof(TextureEntry) == 56);
+
+/**
+ * @brief Subresource of a texture, mapping one-to-one to a VkBufferImageCopy
+ */
+struct RegionEntry {
+    /**
+     * @brief Offset of the subresource data, from the start of the data of its texture
+     */
+    uint64_t bufferOffset;
+    /**
+     * @brief Row length in texels of the subresource data, 0 meaning tightly packed
+     */
+    uint32_t bufferRowLength;
+    /**
+     * @brief Height in texels of the subresource data, 0 meaning tightly packed
+     */
+    uint32_t bufferImageHeight;
+    /**
+     * @brief Mip level of the subresource
+     */
+    uint32_t mipLevel;
+    /**
+     * @brief Width in texels of the subresource
+     */
+    uint32_t width;
+    /**
+     * @brief Height in texels of the subresource
+     */
+    uint32_t height;
+    /**
+     * @brief Size in bytes of the subresource data
+     */
+    uint32_t size;
+};
+static_assert(sizeof(RegionEntry) == 32);
+
+} // namespace magma::asset
@@ -0,0 +1,157 @@
+#include <magma/asset/AssetPack.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace magma::asset {
+
+static bool isInBounds(uint64_t offset, uint64_t size, std::size_t bound)
+{
+    return offset <= bound && size <= bound - offset;
+}
+
+/**
+ * @brief Number of bytes vkCmdCopyBufferToImage reads for a subresource of the given extent
+ */
+static std::optional<uint64_t> subresourceSize(vk::Format format, uint32_t width, uint32_t height)
+{
+    switch (format) {
+    case vk::Format::eR8G8B8A8Unorm:
+    case vk::Format::eR8G8B8A8Srgb:
+        return uint64_t(width) * height * 4;
+    case vk::Format::eBc5UnormBlock:
+    case vk::Format::eBc7UnormBlock:
+    case vk::Format::eBc7SrgbBlock:
+        return uint64_t((width + 3) / 4) * ((height + 3) / 4) * 16;
+    default:
+        return std::nullopt;
+    }
+}
+
+static void validateRegions(const TextureEntry& entry, std::span<const RegionEntry> regions)
+{
+    const auto format = static_cast<vk::Format>(entry.format);
+    if (entry.width == 0 || entry.height == 0 || entry.mipLevels == 0
+        || entry.mipLevels > uint32_t(std::bit_width(std::max(entry.width, entry.height)))
+        || entry.mipLevels != regions.size()) {
+        throw std::runtime_error("Asset pack has a texture with an invalid extent or mip count");
+    }
+    if (!subresourceSize(format, 1, 1)) {
+        throw std::runtime_error("Asset pack has a texture with an unsupported format");
+    }
+    for (uint32_t level = 0; level < entry.mipLevels; level++) {
+        const auto& region = regions[level];
+        if (region.mipLevel != level || region.width != std::max(entry.width >> level, 1u)
+            || region.height != std::max(entry.height >> level, 1u)
+            || (region.bufferRowLength != 0 && region.bufferRowLength < region.width)
+            || (region.bufferImageHeight != 0 && region.bufferImageHeight < region.height)) {
+            throw std::runtime_error("Asset pack has a region not matching its mip level");
+        }
+        const uint64_t requiredSize = *subresourceSize(
+            format,
+            region.bufferRowLength != 0 ? region.bufferRowLength : region.width,
+            region.bufferImageHeight != 0 ? region.bufferImageHeight : region.height);
+        if (region.size < requiredSize) {
+            throw std::runtime_error("Asset pack has a region smaller than its extent");
+        }
+        if (!isInBounds(region.bufferOffset, region.size, std::size_t(entry.dataSize))) {
+            throw std::runtime_error("Asset pack has a region out of its texture data");
+        }
+    }
+}
+
+std::vector<vk::BufferImageCopy> Texture::copyRegions(vk::DeviceSize bufferOffset) const
+{
+    std::vector<vk::BufferImageCopy> copies;
+    copies.reserve(regions.size());
+    for (const auto& region : regions) {
+        copies.push_back(vk::BufferImageCopy {
+            .bufferOffset = bufferOffset + region.bufferOffset,
+            .bufferRowLength = region.bufferRowLength,
+            .bufferImageHeight = region.bufferImageHeight,
+            .imageSubresource = {
+                .aspectMask = vk::ImageAspectFlagBits::eColor,
+                .mipLevel = region.mipLevel,
+                .baseArrayLayer = 0,
+                .layerCount = 1,
+            },
+            .imageOffset = { 0, 0, 0 },
+            .imageExtent = { region.width, region.height, 1 },
+        });
+    }
+    return copies;
+}
+
+AssetPack::AssetPack(std::span<const std::byte> bytes)
+    : bytes_(bytes)
+{
+    if (bytes_.size() < sizeof(PackHeader)) {
+        throw std::runtime_error("Asset pack is too small to hold a header");
+    }
+    const auto& header = *reinterpret_cast<const PackHeader*>(bytes_.data());
+    if (header.magic != packMagic) {
+        throw std::runtime_error("Asset pack has an invalid magic number");
+    }
+    if (header.version != packVersion) {
+        throw std::runtime_error("Asset pack has an unsupported version");
+    }
+    const uint64_t texturesOffset = sizeof(PackHeader);
+    const uint64_t texturesSize = uint64_t(header.textureCount) * sizeof(TextureEntry);
+    const uint64_t regionsOffset = texturesOffset + texturesSize;
+    const uint64_t regionsSize = uint64_t(header.regionCount) * sizeof(RegionEntry);
+    if (!isInBounds(texturesOffset, texturesSize + regionsSize, bytes_.size())
+        || header.namesOffset < regionsOffset + regionsSize
+        || header.dataOffset < header.namesOffset
+        || header.dataOffset > bytes_.size()) {
+        throw std::runtime_error("Asset pack has corrupted tables");
+    }
+    textures_ = { reinterpret_cast<const TextureEntry*>(bytes_.data() + texturesOffset),
+                  header.textureCount };
+    regions_ = { reinterpret_cast<const RegionEntry*>(bytes_.data() + regionsOffset),
+                 header.regionCount };
+    names_ = { reinterpret_cast<const char*>(bytes_.data() + header.namesOffset),
+               std::size_t(header.dataOffset - header.namesOffset) };
+}
+
+Texture AssetPack::texture(std::size_t index) const
+{
+    if (index >= textures_.size()) {
+        throw std::out_of_range("Asset pack texture index out of range");
+    }
+    const auto& entry = textures_[index];
+    if (!isInBounds(entry.dataOffset, entry.dataSize, bytes_.size())
+        || !isInBounds(entry.firstRegion, entry.regionCount, regions_.size())) {
+        throw std::runtime_error("Asset pack has a corrupted texture entry");
+    }
+    const auto regions = regions_.subspan(entry.firstRegion, entry.regionCount);
+    validateRegions(entry, regions);
+    return Texture {
+        .name = nameOf(entry),
+        .format = static_cast<vk::Format>(entry.format),
+        .extent = { entry.width, entry.height, 1 },
+        .mipLevels = entry.mipLevels,
+        .data = bytes_.subspan(std::size_t(entry.dataOffset), std::size_t(entry.dataSize)),
+        .regions = regions,
+    };
+}
+
+std::optional<Texture> AssetPack::findTexture(std::string_view name) const
+{
+    for (std::size_t i = 0; i < textures_.size(); i++) {
+        if (nameOf(textures_[i]) == name) {
+            return texture(i);
+        }
+    }
+    return std::nullopt;
+}
+
+std::string_view AssetPack::nameOf(const TextureEntry& entry) const
+{
+    if (!isInBounds(entry.nameOffset, entry.nameSize, names_.size())) {
+        throw std::runtime_error("Asset pack has a corrupted texture name");
+    }
+    return { names_.data() + entry.nameOffset, entry.nameSize };
+}
+
+} // namespace magma::asset
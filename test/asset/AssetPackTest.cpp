@@ -0,0 +1,142 @@
+#include <magma/asset/AssetPack.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+using namespace magma::asset;
+
+namespace {
+
+/**
+ * @brief Builds in memory a pack holding a single 8x4 RGBA8 texture with its 4 mip levels
+ */
+class AssetPackTest : public ::testing::Test {
+protected:
+    static constexpr uint32_t formatRgba8 = 37; // VK_FORMAT_R8G8B8A8_UNORM
+    static constexpr uint32_t mipLevels = 4;
+
+    void SetUp() override
+    {
+        header = {
+            .magic = packMagic,
+            .version = packVersion,
+            .textureCount = 1,
+            .regionCount = mipLevels,
+            .namesOffset = sizeof(PackHeader) + sizeof(TextureEntry)
+                + mipLevels * sizeof(RegionEntry),
+            .dataOffset = dataAlignment,
+        };
+        uint64_t dataSize = 0;
+        for (uint32_t level = 0; level < mipLevels; level++) {
+            const uint32_t width = std::max(8u >> level, 1u);
+            const uint32_t height = std::max(4u >> level, 1u);
+            regions[level] = {
+                .bufferOffset = dataSize,
+                .bufferRowLength = 0,
+                .bufferImageHeight = 0,
+                .mipLevel = level,
+                .width = width,
+                .height = height,
+                .size = width * height * 4,
+            };
+            dataSize += (regions[level].size + regionAlignment - 1) & ~(regionAlignment - 1);
+        }
+        texture = {
+            .contentHash = 0,
+            .dataOffset = dataAlignment,
+            .dataSize = dataSize,
+            .nameOffset = 0,
+            .nameSize = 4,
+            .format = formatRgba8,
+            .width = 8,
+            .height = 4,
+            .mipLevels = mipLevels,
+            .firstRegion = 0,
+            .regionCount = mipLevels,
+        };
+    }
+
+    std::vector<std::byte> serialize() const
+    {
+        std::vector<std::byte> bytes(std::size_t(texture.dataOffset + texture.dataSize));
+        std::byte* dst = bytes.data();
+        std::memcpy(dst, &header, sizeof(header));
+        std::memcpy(dst + sizeof(header), &texture, sizeof(texture));
+        std::memcpy(dst + sizeof(header) + sizeof(texture), regions.data(), sizeof(regions));
+        std::memcpy(dst + header.namesOffset, "test", 4);
+        return bytes;
+    }
+
+    PackHeader header {};
+    TextureEntry texture {};
+    std::array<RegionEntry, mipLevels> regions {};
+};
+
+} // namespace
+
+TEST_F(AssetPackTest, ReadsValidPack)
+{
+    const auto bytes = serialize();
+    const AssetPack pack(bytes);
+    ASSERT_EQ(pack.textureCount(), 1u);
+    const auto found = pack.findTexture("test");
+    ASSERT_TRUE(found.has_value());
+    EXPECT_EQ(found->extent.width, 8u);
+    EXPECT_EQ(found->extent.height, 4u);
+    EXPECT_EQ(found->mipLevels, mipLevels);
+    EXPECT_EQ(found->data.size(), texture.dataSize);
+    EXPECT_FALSE(pack.findTexture("missing").has_value());
+
+    const auto copies = found->copyRegions(1024);
+    ASSERT_EQ(copies.size(), mipLevels);
+    for (uint32_t level = 0; level < mipLevels; level++) {
+        EXPECT_EQ(copies[level].bufferOffset, 1024 + regions[level].bufferOffset);
+        EXPECT_EQ(copies[level].imageSubresource.mipLevel, level);
+        EXPECT_EQ(copies[level].imageExtent.width, regions[level].width);
+        EXPECT_EQ(copies[level].imageExtent.height, regions[level].height);
+    }
+}
+
+TEST_F(AssetPackTest, RejectsInvalidHeader)
+{
+    header.magic = 0;
+    EXPECT_THROW(AssetPack { serialize() }, std::runtime_error);
+    header.magic = packMagic;
+    header.version = packVersion + 1;
+    EXPECT_THROW(AssetPack { serialize() }, std::runtime_error);
+}
+
+TEST_F(AssetPackTest, RejectsUndersizedRegion)
+{
+    regions[0].size = 16;
+    const auto bytes = serialize();
+    const AssetPack pack(bytes);
+    EXPECT_THROW((void)pack.texture(0), std::runtime_error);
+}
+
+TEST_F(AssetPackTest, RejectsRegionOutOfTextureData)
+{
+    regions[1].bufferOffset = texture.dataSize;
+    const auto bytes = serialize();
+    const AssetPack pack(bytes);
+    EXPECT_THROW((void)pack.texture(0), std::runtime_error);
+}
+
+TEST_F(AssetPackTest, RejectsRegionNotMatchingItsMipLevel)
+{
+    regions[1].mipLevel = 2;
+    EXPECT_THROW((void)AssetPack(serialize()).texture(0), std::runtime_error);
+    regions[1].mipLevel = 1;
+    regions[1].width = 8;
+    EXPECT_THROW((void)AssetPack(serialize()).texture(0), std::runtime_error);
+}
+
+TEST_F(AssetPackTest, RejectsTooManyMipLevels)
+{
+    texture.mipLevels = mipLevels + 1;
+    EXPECT_THROW((void)AssetPack(serialize()).texture(0), std::runtime_error);
+}
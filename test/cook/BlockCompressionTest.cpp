@@ -0,0 +1,196 @@
+#include "BlockCompression.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+
+using namespace magma::cook;
+
+namespace {
+
+using Block = std::array<std::byte, blockSize>;
+
+/**
+ * @brief Little-endian bit stream reading a 128-bit block
+ */
+class BitReader {
+public:
+    explicit BitReader(const Block& block)
+        : block_(block)
+    {
+    }
+
+    int read(unsigned count)
+    {
+        int value = 0;
+        for (unsigned i = 0; i < count; i++, position_++) {
+            const auto byte = std::to_integer<unsigned>(block_[position_ / 8]);
+            value |= int(((byte >> (position_ % 8)) & 1u) << i);
+        }
+        return value;
+    }
+
+private:
+    const Block& block_;
+    unsigned position_ = 0;
+};
+
+/**
+ * @brief Reference decoder of BC7 mode 6 blocks
+ */
+RgbaBlock decodeBc7Mode6(const Block& block)
+{
+    constexpr std::array<int, 16> weights
+        = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+    BitReader reader(block);
+    EXPECT_EQ(reader.read(7), 1 << 6);
+    std::array<std::array<int, 4>, 2> endpoints {};
+    for (std::size_t c = 0; c < 4; c++) {
+        endpoints[0][c] = reader.read(7);
+        endpoints[1][c] = reader.read(7);
+    }
+    for (auto& endpoint : endpoints) {
+        const int pbit = reader.read(1);
+        for (auto& channel : endpoint) {
+            channel = (channel << 1) | pbit;
+        }
+    }
+    RgbaBlock texels {};
+    for (std::size_t texel = 0; texel < 16; texel++) {
+        const int weight = weights[std::size_t(reader.read(texel == 0 ? 3 : 4))];
+        for (std::size_t c = 0; c < 4; c++) {
+            texels[texel * 4 + c] = uint8_t(
+                ((64 - weight) * endpoints[0][c] + weight * endpoints[1][c] + 32) >> 6);
+        }
+    }
+    return texels;
+}
+
+/**
+ * @brief Reference decoder of the red and green channels of BC5 blocks
+ */
+RgbaBlock decodeBc5(const Block& block)
+{
+    RgbaBlock texels {};
+    for (std::size_t channel = 0; channel < 2; channel++) {
+        const auto* half = &block[channel * 8];
+        const int e0 = std::to_integer<int>(half[0]);
+        const int e1 = std::to_integer<int>(half[1]);
+        uint64_t indices = 0;
+        for (std::size_t i = 0; i < 6; i++) {
+            indices |= std::to_integer<uint64_t>(half[2 + i]) << (8 * i);
+        }
+        for (std::size_t texel = 0; texel < 16; texel++) {
+            const int index = int((indices >> (3 * texel)) & 7);
+            int value = 0;
+            if (index < 2) {
+                value = index == 0 ? e0 : e1;
+            } else if (e0 > e1) {
+                value = ((8 - index) * e0 + (index - 1) * e1) / 7;
+            } else if (index < 6) {
+                value = ((6 - index) * e0 + (index - 1) * e1) / 5;
+            } else {
+                value = index == 6 ? 0 : 255;
+            }
+            texels[texel * 4 + channel] = uint8_t(value);
+        }
+    }
+    return texels;
+}
+
+int maxError(const RgbaBlock& expected, const RgbaBlock& actual, std::size_t channels)
+{
+    int error = 0;
+    for (std::size_t texel = 0; texel < 16; texel++) {
+        for (std::size_t c = 0; c < channels; c++) {
+            error = std::max(error, std::abs(expected[texel * 4 + c] - actual[texel * 4 + c]));
+        }
+    }
+    return error;
+}
+
+RgbaBlock makeBlock(auto texelAt)
+{
+    RgbaBlock block {};
+    for (std::size_t texel = 0; texel < 16; texel++) {
+        const auto rgba = texelAt(texel % 4, texel / 4);
+        std::copy(rgba.begin(), rgba.end(), &block[texel * 4]);
+    }
+    return block;
+}
+
+using Rgba = std::array<uint8_t, 4>;
+
+} // namespace
+
+TEST(BlockCompressionTest, Bc7RoundTripsFlatBlock)
+{
+    const auto block = makeBlock([](auto, auto) { return Rgba { 12, 200, 77, 255 }; });
+    Block encoded;
+    encodeBc7Block(block, encoded.data());
+    EXPECT_LE(maxError(block, decodeBc7Mode6(encoded), 4), 1);
+}
+
+TEST(BlockCompressionTest, Bc7RoundTripsAntiCorrelatedGradient)
+{
+    const auto block = makeBlock([](std::size_t x, std::size_t y) {
+        const auto value = uint8_t((y * 4 + x) * 17);
+        return Rgba { uint8_t(255 - value), value, 1, 255 };
+    });
+    Block encoded;
+    encodeBc7Block(block, encoded.data());
+    EXPECT_LE(maxError(block, decodeBc7Mode6(encoded), 4), 4);
+}
+
+TEST(BlockCompressionTest, Bc7RoundTripsRedGreenChecker)
+{
+    const auto block = makeBlock([](std::size_t x, std::size_t y) {
+        return (x + y) % 2 ? Rgba { 255, 0, 0, 255 } : Rgba { 0, 255, 0, 255 };
+    });
+    Block encoded;
+    encodeBc7Block(block, encoded.data());
+    EXPECT_LE(maxError(block, decodeBc7Mode6(encoded), 4), 2);
+}
+
+TEST(BlockCompressionTest, Bc7KeepsOpaqueAlphaExact)
+{
+    const auto block = makeBlock([](std::size_t x, std::size_t y) {
+        return Rgba { uint8_t(x * 60), uint8_t(y * 31), uint8_t(x * y * 9), 255 };
+    });
+    Block encoded;
+    encodeBc7Block(block, encoded.data());
+    const auto decoded = decodeBc7Mode6(encoded);
+    for (std::size_t texel = 0; texel < 16; texel++) {
+        EXPECT_EQ(decoded[texel * 4 + 3], 255);
+    }
+}
+
+TEST(BlockCompressionTest, Bc5RoundTripsRedAndGreen)
+{
+    const auto block = makeBlock([](std::size_t x, std::size_t y) {
+        return Rgba { uint8_t(40 + x * 50), uint8_t(230 - y * 20), 0, 255 };
+    });
+    Block encoded;
+    encodeBc5Block(block, encoded.data());
+    // Each channel spans 150 and 60 levels, interpolated with 8 values
+    EXPECT_LE(maxError(block, decodeBc5(encoded), 2), 150 / 14 + 1);
+}
+
+TEST(BlockCompressionTest, Bc5RoundTripsFlatChannels)
+{
+    const auto block = makeBlock([](auto, auto) { return Rgba { 3, 250, 0, 255 }; });
+    Block encoded;
+    encodeBc5Block(block, encoded.data());
+    EXPECT_EQ(maxError(block, decodeBc5(encoded), 2), 0);
+}
+
+TEST(BlockCompressionTest, CompressesPartialBlocks)
+{
+    const Rgba8Image image {
+        .width = 5,
+        .height = 3,
+        .texels = std::vector<uint8_t>(5 * 3 * 4, 128),
+    };
+    EXPECT_EQ(compressBc7(image).size(), 2 * 1 * blockSize);
+    EXPECT_EQ(compressBc5(image).size(), 2 * 1 * blockSize);
+}
@@ -0,0 +1,102 @@
+#include "Cooker.hpp"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+
+using namespace magma::cook;
+
+namespace {
+
+/**
+ * @brief Provides a scratch directory holding a small binary PPM texture
+ */
+class CookerTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        directory = std::filesystem::temp_directory_path() / "magma-cook-test"
+            / ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+        source = directory / "texture.ppm";
+        std::ofstream file(source, std::ios::binary);
+        file << "P6 6 5 255\n";
+        for (int texel = 0; texel < 6 * 5; texel++) {
+            file.put(char(texel * 8));
+            file.put(char(255 - texel * 8));
+            file.put(char(64));
+        }
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(directory);
+    }
+
+    std::size_t cacheEntryCount() const
+    {
+        std::size_t count = 0;
+        for (const auto& entry : std::filesystem::directory_iterator(directory / "cache")) {
+            count += entry.path().extension() == ".cooked" ? 1u : 0u;
+        }
+        return count;
+    }
+
+    std::filesystem::path directory;
+    std::filesystem::path source;
+};
+
+} // namespace
+
+TEST_F(CookerTest, ReusesCachedTexture)
+{
+    const Cooker cooker(directory / "cache");
+    bool cacheHit = true;
+    const auto cooked = cooker.cook({ .source = source, .format = TextureFormat::Bc7 }, cacheHit);
+    EXPECT_FALSE(cacheHit);
+    EXPECT_EQ(cooked.width, 6u);
+    EXPECT_EQ(cooked.height, 5u);
+    EXPECT_EQ(cooked.regions.size(), 3u);
+
+    const auto cached = cooker.cook({ .source = source, .format = TextureFormat::Bc7 }, cacheHit);
+    EXPECT_TRUE(cacheHit);
+    EXPECT_EQ(cached.contentHash, cooked.contentHash);
+    EXPECT_EQ(cached.data, cooked.data);
+}
+
+TEST_F(CookerTest, CooksAgainCorruptedCacheEntry)
+{
+    const Cooker cooker(directory / "cache");
+    bool cacheHit = false;
+    const auto cooked = cooker.cook({ .source = source, .format = TextureFormat::Bc5 }, cacheHit);
+    for (const auto& entry : std::filesystem::directory_iterator(directory / "cache")) {
+        std::filesystem::resize_file(entry.path(), std::filesystem::file_size(entry.path()) / 2);
+    }
+    const auto recooked = cooker.cook({ .source = source, .format = TextureFormat::Bc5 }, cacheHit);
+    EXPECT_FALSE(cacheHit);
+    EXPECT_EQ(recooked.data, cooked.data);
+}
+
+TEST_F(CookerTest, RemovesStaleEntries)
+{
+    const Cooker cooker(directory / "cache");
+    bool cacheHit = false;
+    const auto rgba8 = cooker.cook({ .source = source, .format = TextureFormat::Rgba8 }, cacheHit);
+    const auto bc7 = cooker.cook({ .source = source, .format = TextureFormat::Bc7 }, cacheHit);
+    ASSERT_EQ(cacheEntryCount(), 2u);
+    const std::vector<uint64_t> usedHashes { bc7.contentHash };
+    EXPECT_EQ(cooker.removeStaleEntries(usedHashes), 1u);
+    EXPECT_EQ(cacheEntryCount(), 1u);
+    cooker.cook({ .source = source, .format = TextureFormat::Bc7 }, cacheHit);
+    EXPECT_TRUE(cacheHit);
+}
+
+TEST(TextureFormatTest, ParsesCommandLineNames)
+{
+    EXPECT_EQ(parseTextureFormat("bc7-srgb"), TextureFormat::Bc7Srgb);
+    EXPECT_EQ(parseTextureFormat("bc5"), TextureFormat::Bc5);
+    EXPECT_EQ(parseTextureFormat("rgba8"), TextureFormat::Rgba8);
+    EXPECT_FALSE(parseTextureFormat("bc1").has_value());
+}
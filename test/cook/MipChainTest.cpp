@@ -0,0 +1,73 @@
+#include "MipChain.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace magma::cook;
+
+namespace {
+
+Rgba32fImage makeImage(uint32_t width, uint32_t height)
+{
+    return Rgba32fImage {
+        .width = width,
+        .height = height,
+        .texels = std::vector<float>(std::size_t(width) * height * 4, 0.0f),
+    };
+}
+
+float& red(Rgba32fImage& image, uint32_t x, uint32_t y)
+{
+    return image.texels[(std::size_t(y) * image.width + x) * 4];
+}
+
+float meanRed(Rgba32fImage& image)
+{
+    float sum = 0.0f;
+    for (uint32_t y = 0; y < image.height; y++) {
+        for (uint32_t x = 0; x < image.width; x++) {
+            sum += red(image, x, y);
+        }
+    }
+    return sum / float(image.width * image.height);
+}
+
+} // namespace
+
+TEST(MipChainTest, AveragesEvenSizes)
+{
+    auto image = makeImage(4, 2);
+    red(image, 0, 0) = 1.0f;
+    red(image, 3, 1) = 0.5f;
+    auto mip = downsample(image);
+    ASSERT_EQ(mip.width, 2u);
+    ASSERT_EQ(mip.height, 1u);
+    EXPECT_FLOAT_EQ(red(mip, 0, 0), 0.25f);
+    EXPECT_FLOAT_EQ(red(mip, 1, 0), 0.125f);
+}
+
+TEST(MipChainTest, KeepsLastColumnOfOddSizes)
+{
+    auto image = makeImage(5, 3);
+    for (uint32_t y = 0; y < image.height; y++) {
+        red(image, 4, y) = 1.0f;
+    }
+    auto mips = buildMipChain(image);
+    ASSERT_EQ(mips.size(), 3u);
+    ASSERT_EQ(mips[1].width, 2u);
+    ASSERT_EQ(mips[1].height, 1u);
+    EXPECT_FLOAT_EQ(red(mips[1], 0, 0), 0.0f);
+    EXPECT_FLOAT_EQ(red(mips[1], 1, 0), 0.4f);
+    for (auto& mip : mips) {
+        EXPECT_FLOAT_EQ(meanRed(mip), 0.2f);
+    }
+}
+
+TEST(MipChainTest, BuildsChainDownTo1x1)
+{
+    const auto mips = buildMipChain(makeImage(67, 45));
+    ASSERT_EQ(mips.size(), 7u);
+    EXPECT_EQ(mips[1].width, 33u);
+    EXPECT_EQ(mips[1].height, 22u);
+    EXPECT_EQ(mips.back().width, 1u);
+    EXPECT_EQ(mips.back().height, 1u);
+}
@@ -0,0 +1,100 @@
+#include "PackWriter.hpp"
+
+#include <magma/asset/AssetPack.hpp>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <iterator>
+
+using namespace magma::cook;
+
+namespace {
+
+std::vector<std::byte> readFile(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::vector<char> content((std::istreambuf_iterator<char>(file)), {});
+    const auto bytes = std::as_bytes(std::span(content));
+    return { bytes.begin(), bytes.end() };
+}
+
+/**
+ * @brief Cooked 4x2 RGBA8 texture with its 3 mip levels, filled with value
+ */
+CookedTexture makeRgba8Texture(std::byte value)
+{
+    CookedTexture texture {
+        .contentHash = 42,
+        .format = 37, // VK_FORMAT_R8G8B8A8_UNORM
+        .width = 4,
+        .height = 2,
+        .regions = {},
+        .data = {},
+    };
+    const std::array<std::array<uint32_t, 2>, 3> extents { { { 4, 2 }, { 2, 1 }, { 1, 1 } } };
+    for (uint32_t level = 0; level < extents.size(); level++) {
+        const auto [width, height] = extents[level];
+        texture.regions.push_back({
+            .bufferOffset = texture.data.size(),
+            .bufferRowLength = 0,
+            .bufferImageHeight = 0,
+            .mipLevel = level,
+            .width = width,
+            .height = height,
+            .size = width * height * 4,
+        });
+        const auto alignedSize = (width * height * 4 + magma::asset::regionAlignment - 1)
+            & ~(magma::asset::regionAlignment - 1);
+        texture.data.resize(texture.data.size() + alignedSize, value);
+    }
+    return texture;
+}
+
+class PackWriterTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        path = std::filesystem::temp_directory_path()
+            / (std::string("magma-cook-test-")
+               + ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".assetpack");
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(path);
+    }
+
+    std::filesystem::path path;
+};
+
+} // namespace
+
+TEST_F(PackWriterTest, RoundTripsEmptyPack)
+{
+    writePack(path, {});
+    const auto bytes = readFile(path);
+    EXPECT_EQ(bytes.size(), magma::asset::dataAlignment);
+    const magma::asset::AssetPack pack(bytes);
+    EXPECT_EQ(pack.textureCount(), 0u);
+}
+
+TEST_F(PackWriterTest, RoundTripsTextures)
+{
+    writePack(
+        path,
+        {
+            { .name = "first", .texture = makeRgba8Texture(std::byte { 1 }) },
+            { .name = "second", .texture = makeRgba8Texture(std::byte { 2 }) },
+        });
+    const auto bytes = readFile(path);
+    const magma::asset::AssetPack pack(bytes);
+    ASSERT_EQ(pack.textureCount(), 2u);
+    for (std::size_t i = 0; i < 2; i++) {
+        const auto texture = pack.texture(i);
+        EXPECT_EQ(texture.name, i == 0 ? "first" : "second");
+        EXPECT_EQ(texture.mipLevels, 3u);
+        EXPECT_EQ(uint64_t(texture.data.data() - bytes.data()) % magma::asset::dataAlignment, 0u);
+        EXPECT_EQ(texture.data[0], std::byte(i + 1));
+    }
+}
@@ -0,0 +1,343 @@
+#include "BlockCompression.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace magma::cook {
+
+namespace {
+
+/**
+ * @brief Little-endian bit stream used to assemble a 128-bit block
+ */
+class BitWriter {
+public:
+    void write(uint32_t value, unsigned count)
+    {
+        for (unsigned i = 0; i < count; i++, position_++) {
+            if ((value >> i) & 1u) {
+                bytes_[position_ / 8] |= uint8_t(1u << (position_ % 8));
+            }
+        }
+    }
+
+    void copyTo(std::byte* dst) const
+    {
+        std::transform(bytes_.begin(), bytes_.end(), dst, [](uint8_t b) { return std::byte(b); });
+    }
+
+private:
+    std::array<uint8_t, blockSize> bytes_ {};
+    unsigned position_ = 0;
+};
+
+using Color = std::array<float, 4>;
+using Endpoint = std::array<int, 4>;
+
+constexpr std::array<int, 16> bc7Weights4
+    = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+struct Bc7Fit {
+    std::array<Endpoint, 2> endpoints;
+    std::array<int, 2> pbits;
+    std::array<uint8_t, 16> indices;
+    int error = std::numeric_limits<int>::max();
+};
+
+/**
+ * @brief Selects the best index of each texel for the given quantized endpoints
+ */
+void selectBc7Indices(const RgbaBlock& block, Bc7Fit& fit)
+{
+    std::array<Endpoint, 16> palette;
+    for (std::size_t i = 0; i < palette.size(); i++) {
+        for (std::size_t c = 0; c < 4; c++) {
+            palette[i][c] = ((64 - bc7Weights4[i]) * fit.endpoints[0][c]
+                             + bc7Weights4[i] * fit.endpoints[1][c] + 32)
+                >> 6;
+        }
+    }
+    fit.error = 0;
+    for (std::size_t texel = 0; texel < 16; texel++) {
+        int bestError = std::numeric_limits<int>::max();
+        for (std::size_t i = 0; i < palette.size(); i++) {
+            int error = 0;
+            for (std::size_t c = 0; c < 4; c++) {
+                const int delta = palette[i][c] - block[texel * 4 + c];
+                error += delta * delta;
+            }
+            if (error < bestError) {
+                bestError = error;
+                fit.indices[texel] = uint8_t(i);
+            }
+        }
+        fit.error += bestError;
+    }
+}
+
+/**
+ * @brief Quantizes float endpoints to 7 bits plus p-bit, keeping the p-bits giving the best fit
+ */
+Bc7Fit quantizeBc7Endpoints(const RgbaBlock& block, const std::array<Color, 2>& endpoints)
+{
+    // Opaque blocks must keep an alpha of exactly 255, which only odd endpoints can represent
+    bool opaque = true;
+    for (std::size_t texel = 0; texel < 16; texel++) {
+        opaque = opaque && block[texel * 4 + 3] == 255;
+    }
+    const int firstPbit = opaque ? 1 : 0;
+    Bc7Fit best;
+    for (int p0 = firstPbit; p0 < 2; p0++) {
+        for (int p1 = firstPbit; p1 < 2; p1++) {
+            Bc7Fit fit { .endpoints = {}, .pbits = { p0, p1 }, .indices = {} };
+            for (std::size_t e = 0; e < 2; e++) {
+                for (std::size_t c = 0; c < 4; c++) {
+                    const float value = (endpoints[e][c] - float(fit.pbits[e])) / 2.0f;
+                    const int quantized = std::clamp(int(std::lround(value)), 0, 127);
+                    fit.endpoints[e][c] = (quantized << 1) | fit.pbits[e];
+                }
+            }
+            selectBc7Indices(block, fit);
+            if (fit.error < best.error) {
+                best = fit;
+            }
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Computes the endpoints minimizing the squared error for the given indices
+ */
+bool refitBc7Endpoints(const RgbaBlock& block, const Bc7Fit& fit, std::array<Color, 2>& endpoints)
+{
+    float aa = 0.0f;
+    float ab = 0.0f;
+    float bb = 0.0f;
+    Color ax {};
+    Color bx {};
+    for (std::size_t texel = 0; texel < 16; texel++) {
+        const float b = float(bc7Weights4[fit.indices[texel]]) / 64.0f;
+        const float a = 1.0f - b;
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+        for (std::size_t c = 0; c < 4; c++) {
+            ax[c] += a * float(block[texel * 4 + c]);
+            bx[c] += b * float(block[texel * 4 + c]);
+        }
+    }
+    const float determinant = aa * bb - ab * ab;
+    if (std::abs(determinant) < 1e-6f) {
+        return false;
+    }
+    for (std::size_t c = 0; c < 4; c++) {
+        endpoints[0][c] = std::clamp((ax[c] * bb - bx[c] * ab) / determinant, 0.0f, 255.0f);
+        endpoints[1][c] = std::clamp((bx[c] * aa - ax[c] * ab) / determinant, 0.0f, 255.0f);
+    }
+    return true;
+}
+
+/**
+ * @brief Computes initial endpoints as the extent of the block along its principal axis
+ */
+std::array<Color, 2> principalAxisEndpoints(const RgbaBlock& block)
+{
+    Color mean {};
+    for (std::size_t texel = 0; texel < 16; texel++) {
+        for (std::size_t c = 0; c < 4; c++) {
+            mean[c] += float(block[texel * 4 + c]) / 16.0f;
+        }
+    }
+    std::array<Color, 4> covariance {};
+    for (std::size_t texel = 0; texel < 16; texel++) {
+        for (std::size_t i = 0; i < 4; i++) {
+            for (std::size_t j = 0; j < 4; j++) {
+                covariance[i][j] += (float(block[texel * 4 + i]) - mean[i])
+                    * (float(block[texel * 4 + j]) - mean[j]);
+            }
+        }
+    }
+    // Power iteration, seeded with the covariance row of largest norm: being in the range of the
+    // covariance, it only vanishes under the iteration if the covariance itself is null
+    std::size_t seedRow = 0;
+    float seedNorm = 0.0f;
+    for (std::size_t i = 0; i < 4; i++) {
+        float norm = 0.0f;
+        for (float value : covariance[i]) {
+            norm += value * value;
+        }
+        if (norm > seedNorm) {
+            seedNorm = norm;
+            seedRow = i;
+        }
+    }
+    Color axis = covariance[seedRow];
+    for (int iteration = 0; iteration < 8; iteration++) {
+        Color next {};
+        float norm = 0.0f;
+        for (std::size_t i = 0; i < 4; i++) {
+            for (std::size_t j = 0; j < 4; j++) {
+                next[i] += covariance[i][j] * axis[j];
+            }
+            norm = std::max(norm, std::abs(next[i]));
+        }
+        if (norm < 1e-6f) {
+            break;
+        }
+        for (std::size_t i = 0; i < 4; i++) {
+            axis[i] = next[i] / norm;
+        }
+    }
+    float length = 0.0f;
+    for (float value : axis) {
+        length += value * value;
+    }
+    if (length < 1e-12f) {
+        // The iteration degenerated, fall back to the diagonal of the bounding box of the block
+        Color minColor { 255.0f, 255.0f, 255.0f, 255.0f };
+        Color maxColor {};
+        for (std::size_t texel = 0; texel < 16; texel++) {
+            for (std::size_t c = 0; c < 4; c++) {
+                minColor[c] = std::min(minColor[c], float(block[texel * 4 + c]));
+                maxColor[c] = std::max(maxColor[c], float(block[texel * 4 + c]));
+            }
+        }
+        length = 0.0f;
+        for (std::size_t c = 0; c < 4; c++) {
+            axis[c] = maxColor[c] - minColor[c];
+            length += axis[c] * axis[c];
+        }
+        if (length == 0.0f) {
+            // Flat block, represented exactly by a single color
+            return { mean, mean };
+        }
+    }
+    length = std::sqrt(length);
+    float minProjection = std::numeric_limits<float>::max();
+    float maxProjection = std::numeric_limits<float>::lowest();
+    for (std::size_t texel = 0; texel < 16; texel++) {
+        float projection = 0.0f;
+        for (std::size_t c = 0; c < 4; c++) {
+            projection += (float(block[texel * 4 + c]) - mean[c]) * axis[c] / length;
+        }
+        minProjection = std::min(minProjection, projection);
+        maxProjection = std::max(maxProjection, projection);
+    }
+    std::array<Color, 2> endpoints;
+    for (std::size_t c = 0; c < 4; c++) {
+        endpoints[0][c] = std::clamp(mean[c] + axis[c] / length * minProjection, 0.0f, 255.0f);
+        endpoints[1][c] = std::clamp(mean[c] + axis[c] / length * maxProjection, 0.0f, 255.0f);
+    }
+    return endpoints;
+}
+
+void encodeBc4Block(const RgbaBlock& block, std::size_t channel, std::byte* dst)
+{
+    uint8_t maxValue = 0;
+    uint8_t minValue = 255;
+    for (std::size_t texel = 0; texel < 16; texel++) {
+        maxValue = std::max(maxValue, block[texel * 4 + channel]);
+        minValue = std::min(minValue, block[texel * 4 + channel]);
+    }
+    // With endpoint0 > endpoint1, index 0 and 1 select the endpoints and the 6 others interpolate
+    std::array<int, 8> palette { maxValue, minValue };
+    for (int i = 1; i < 7; i++) {
+        palette[std::size_t(i + 1)] = ((7 - i) * maxValue + i * minValue + 3) / 7;
+    }
+    uint64_t bits = uint64_t(maxValue) | (uint64_t(minValue) << 8);
+    if (maxValue != minValue) {
+        for (std::size_t texel = 0; texel < 16; texel++) {
+            const int value = block[texel * 4 + channel];
+            uint64_t bestIndex = 0;
+            for (std::size_t i = 1; i < palette.size(); i++) {
+                if (std::abs(palette[i] - value) < std::abs(palette[bestIndex] - value)) {
+                    bestIndex = i;
+                }
+            }
+            bits |= bestIndex << (16 + 3 * texel);
+        }
+    }
+    for (std::size_t i = 0; i < 8; i++) {
+        dst[i] = std::byte(bits >> (8 * i));
+    }
+}
+
+template<typename TBlockEncoder>
+std::vector<std::byte> compressBlocks(const Rgba8Image& image, TBlockEncoder encodeBlock)
+{
+    const uint32_t blocksX = (image.width + 3) / 4;
+    const uint32_t blocksY = (image.height + 3) / 4;
+    std::vector<std::byte> result(std::size_t(blocksX) * blocksY * blockSize);
+    std::byte* dst = result.data();
+    RgbaBlock block;
+    for (uint32_t by = 0; by < blocksY; by++) {
+        for (uint32_t bx = 0; bx < blocksX; bx++, dst += blockSize) {
+            // Texels outside of the image replicate the edges, they are never sampled anyway
+            for (uint32_t y = 0; y < 4; y++) {
+                const uint32_t srcY = std::min(by * 4 + y, image.height - 1);
+                for (uint32_t x = 0; x < 4; x++) {
+                    const uint32_t srcX = std::min(bx * 4 + x, image.width - 1);
+                    const auto* src = &image.texels[(std::size_t(srcY) * image.width + srcX) * 4];
+                    std::copy_n(src, 4, &block[(y * 4 + x) * 4]);
+                }
+            }
+            encodeBlock(block, dst);
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+void encodeBc5Block(const RgbaBlock& block, std::byte* dst)
+{
+    encodeBc4Block(block, 0, dst);
+    encodeBc4Block(block, 1, dst + 8);
+}
+
+void encodeBc7Block(const RgbaBlock& block, std::byte* dst)
+{
+    auto endpoints = principalAxisEndpoints(block);
+    Bc7Fit fit = quantizeBc7Endpoints(block, endpoints);
+    if (fit.error > 0 && refitBc7Endpoints(block, fit, endpoints)) {
+        Bc7Fit refined = quantizeBc7Endpoints(block, endpoints);
+        if (refined.error < fit.error) {
+            fit = refined;
+        }
+    }
+    // The most significant bit of the first index is implicit and must be zero
+    if (fit.indices[0] & 0x8) {
+        std::swap(fit.endpoints[0], fit.endpoints[1]);
+        std::swap(fit.pbits[0], fit.pbits[1]);
+        for (auto& index : fit.indices) {
+            index = uint8_t(15 - index);
+        }
+    }
+    BitWriter writer;
+    writer.write(1u << 6, 7); // Mode 6
+    for (std::size_t c = 0; c < 4; c++) {
+        writer.write(uint32_t(fit.endpoints[0][c] >> 1), 7);
+        writer.write(uint32_t(fit.endpoints[1][c] >> 1), 7);
+    }
+    writer.write(uint32_t(fit.pbits[0]), 1);
+    writer.write(uint32_t(fit.pbits[1]), 1);
+    writer.write(fit.indices[0], 3);
+    for (std::size_t texel = 1; texel < 16; texel++) {
+        writer.write(fit.indices[texel], 4);
+    }
+    writer.copyTo(dst);
+}
+
+std::vector<std::byte> compressBc5(const Rgba8Image& image)
+{
+    return compressBlocks(image, encodeBc5Block);
+}
+
+std::vector<std::byte> compressBc7(const Rgba8Image& image)
+{
+    return compressBlocks(image, encodeBc7Block);
+}
+
+} // namespace magma::cook
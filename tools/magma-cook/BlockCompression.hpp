@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Image.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace magma::cook {
+
+/**
+ * @brief 4x4 block of RGBA texels, in row-major order
+ */
+using RgbaBlock = std::array<uint8_t, 16 * 4>;
+
+/**
+ * @brief Size in bytes of a BC5 or BC7 block
+ */
+inline constexpr std::size_t blockSize = 16;
+
+/**
+ * @brief Encodes the red and green channels of block as a BC5 block
+ */
+void encodeBc5Block(const RgbaBlock& block, std::byte* dst);
+
+/**
+ * @brief Encodes block as a BC7 block
+ *
+ * Only mode 6 (single subset, RGBA endpoints, 4-bit indices) is used: endpoints are fitted along
+ * the principal axis of the block, refined by least squares, and quantized with the best p-bits.
+ */
+void encodeBc7Block(const RgbaBlock& block, std::byte* dst);
+
+/**
+ * @brief Compresses image to BC5, blocks being laid out in row-major order
+ */
+std::vector<std::byte> compressBc5(const Rgba8Image& image);
+
+/**
+ * @brief Compresses image to BC7, blocks being laid out in row-major order
+ */
+std::vector<std::byte> compressBc7(const Rgba8Image& image);
+
+} // namespace magma::cook
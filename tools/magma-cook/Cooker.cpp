@@ -0,0 +1,325 @@
+#include "Cooker.hpp"
+
+#include "BlockCompression.hpp"
+#include "Image.hpp"
+#include "MipChain.hpp"
+
+#include <vulkan/vulkan_core.h>
+
+#include <array>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <utility>
+
+namespace magma::cook {
+
+/**
+ * @brief Version of the cooking process, to bump whenever its output changes
+ */
+static constexpr uint32_t cookVersion = 3;
+
+#ifndef MAGMA_COOK_DECODER_REVISION
+#error "MAGMA_COOK_DECODER_REVISION must identify the revision of the image decoder"
+#endif
+
+/**
+ * @brief Revision of the image decoder, whose output is part of the cooked textures
+ */
+static constexpr std::string_view decoderRevision = MAGMA_COOK_DECODER_REVISION;
+
+/**
+ * @brief Magic number identifying a cached cooked texture ("MGCK")
+ */
+static constexpr uint32_t cacheMagic = 0x4b43474d;
+
+/**
+ * @brief Header of a cached cooked texture, followed by its regions and data
+ */
+struct CacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t contentHash;
+    uint32_t format;
+    uint32_t width;
+    uint32_t height;
+    uint32_t regionCount;
+    uint64_t dataSize;
+};
+
+struct FormatInfo {
+    std::string_view name;
+    TextureFormat format;
+    VkFormat vkFormat;
+    bool srgb;
+};
+
+static constexpr std::array formatInfos = {
+    FormatInfo { "rgba8", TextureFormat::Rgba8, VK_FORMAT_R8G8B8A8_UNORM, false },
+    FormatInfo { "rgba8-srgb", TextureFormat::Rgba8Srgb, VK_FORMAT_R8G8B8A8_SRGB, true },
+    FormatInfo { "bc5", TextureFormat::Bc5, VK_FORMAT_BC5_UNORM_BLOCK, false },
+    FormatInfo { "bc7", TextureFormat::Bc7, VK_FORMAT_BC7_UNORM_BLOCK, false },
+    FormatInfo { "bc7-srgb", TextureFormat::Bc7Srgb, VK_FORMAT_BC7_SRGB_BLOCK, true },
+};
+
+static const FormatInfo& infoOf(TextureFormat format)
+{
+    for (const auto& info : formatInfos) {
+        if (info.format == format) {
+            return info;
+        }
+    }
+    throw std::logic_error("Unsupported TextureFormat");
+}
+
+std::optional<TextureFormat> parseTextureFormat(std::string_view name)
+{
+    for (const auto& info : formatInfos) {
+        if (info.name == name) {
+            return info.format;
+        }
+    }
+    return std::nullopt;
+}
+
+uint32_t toUint32(uint64_t value, std::string_view what)
+{
+    if (value > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error(std::string(what) + " does not fit in 32 bits");
+    }
+    return uint32_t(value);
+}
+
+std::filesystem::path temporaryPathFor(const std::filesystem::path& path)
+{
+    thread_local std::mt19937_64 generator { std::random_device {}() };
+    auto temporaryPath = path;
+    temporaryPath += "." + std::to_string(generator()) + ".tmp";
+    return temporaryPath;
+}
+
+/**
+ * @brief 64-bit FNV-1a hash
+ */
+class ContentHasher {
+public:
+    void update(std::span<const std::byte> bytes)
+    {
+        for (std::byte byte : bytes) {
+            hash_ = (hash_ ^ uint64_t(byte)) * 0x100000001b3;
+        }
+    }
+
+    template<typename T>
+    void update(const T& value)
+    {
+        update(std::as_bytes(std::span(&value, 1)));
+    }
+
+    [[nodiscard]] uint64_t hash() const noexcept
+    {
+        return hash_;
+    }
+
+private:
+    uint64_t hash_ = 0xcbf29ce484222325;
+};
+
+static std::vector<std::byte> readFile(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        throw std::runtime_error("cannot open " + path.string());
+    }
+    std::vector<std::byte> content(std::size_t(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(content.data()), std::streamsize(content.size()));
+    if (!file) {
+        throw std::runtime_error("cannot read " + path.string());
+    }
+    return content;
+}
+
+template<typename T>
+static bool readPod(std::istream& stream, T* values, std::size_t count = 1)
+{
+    stream.read(reinterpret_cast<char*>(values), std::streamsize(sizeof(T) * count));
+    return bool(stream);
+}
+
+template<typename T>
+static void writePod(std::ostream& stream, const T* values, std::size_t count = 1)
+{
+    stream.write(reinterpret_cast<const char*>(values), std::streamsize(sizeof(T) * count));
+}
+
+static std::optional<CookedTexture> loadCached(const std::filesystem::path& path, uint64_t hash)
+{
+    std::ifstream file(path, std::ios::binary);
+    CacheHeader header;
+    if (!file || !readPod(file, &header) || header.magic != cacheMagic
+        || header.version != cookVersion || header.contentHash != hash) {
+        return std::nullopt;
+    }
+    // Any inconsistency with the actual file size is a corrupted entry, to be cooked again
+    std::error_code error;
+    const uint64_t fileSize = std::filesystem::file_size(path, error);
+    const uint64_t payloadSize = fileSize - sizeof(CacheHeader);
+    if (error || fileSize < sizeof(CacheHeader)
+        || header.regionCount > payloadSize / sizeof(asset::RegionEntry)
+        || header.dataSize != payloadSize - header.regionCount * sizeof(asset::RegionEntry)) {
+        return std::nullopt;
+    }
+    CookedTexture texture {
+        .contentHash = header.contentHash,
+        .format = header.format,
+        .width = header.width,
+        .height = header.height,
+        .regions = std::vector<asset::RegionEntry>(header.regionCount),
+        .data = std::vector<std::byte>(std::size_t(header.dataSize)),
+    };
+    if (!readPod(file, texture.regions.data(), texture.regions.size())
+        || !readPod(file, texture.data.data(), texture.data.size())) {
+        return std::nullopt;
+    }
+    for (const auto& region : texture.regions) {
+        if (region.bufferOffset > header.dataSize
+            || region.size > header.dataSize - region.bufferOffset) {
+            return std::nullopt;
+        }
+    }
+    return texture;
+}
+
+static void storeCached(const std::filesystem::path& path, const CookedTexture& texture)
+{
+    // Write to a temporary file first so that a concurrent or interrupted run never sees a
+    // partially written entry
+    const auto temporaryPath = temporaryPathFor(path);
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        const CacheHeader header {
+            .magic = cacheMagic,
+            .version = cookVersion,
+            .contentHash = texture.contentHash,
+            .format = texture.format,
+            .width = texture.width,
+            .height = texture.height,
+            .regionCount = toUint32(texture.regions.size(), "region count"),
+            .dataSize = texture.data.size(),
+        };
+        writePod(file, &header);
+        writePod(file, texture.regions.data(), texture.regions.size());
+        writePod(file, texture.data.data(), texture.data.size());
+        if (!file) {
+            throw std::runtime_error("cannot write " + temporaryPath.string());
+        }
+    }
+    std::filesystem::rename(temporaryPath, path);
+}
+
+static std::vector<std::byte> encodeLevel(const Rgba8Image& image, TextureFormat format)
+{
+    switch (format) {
+    case TextureFormat::Rgba8:
+    case TextureFormat::Rgba8Srgb: {
+        const auto bytes = std::as_bytes(std::span(image.texels));
+        return { bytes.begin(), bytes.end() };
+    }
+    case TextureFormat::Bc5:
+        return compressBc5(image);
+    case TextureFormat::Bc7:
+    case TextureFormat::Bc7Srgb:
+        return compressBc7(image);
+    }
+    throw std::logic_error("Unsupported TextureFormat");
+}
+
+static CookedTexture cookImage(Rgba8Image image, TextureFormat format, uint64_t contentHash)
+{
+    const auto& info = infoOf(format);
+    CookedTexture texture {
+        .contentHash = contentHash,
+        .format = uint32_t(info.vkFormat),
+        .width = image.width,
+        .height = image.height,
+        .regions = {},
+        .data = {},
+    };
+    // Filter in linear space, but store the first level as is to avoid a lossy round-trip
+    const auto mips = buildMipChain(toRgba32f(image, info.srgb));
+    for (std::size_t level = 0; level < mips.size(); level++) {
+        const auto encoded
+            = encodeLevel(level == 0 ? image : toRgba8(mips[level], info.srgb), format);
+        const uint64_t offset = (texture.data.size() + asset::regionAlignment - 1)
+            & ~(asset::regionAlignment - 1);
+        texture.regions.push_back(asset::RegionEntry {
+            .bufferOffset = offset,
+            .bufferRowLength = 0,
+            .bufferImageHeight = 0,
+            .mipLevel = uint32_t(level),
+            .width = mips[level].width,
+            .height = mips[level].height,
+            .size = toUint32(encoded.size(), "mip level size"),
+        });
+        texture.data.resize(std::size_t(offset));
+        texture.data.insert(texture.data.end(), encoded.begin(), encoded.end());
+    }
+    return texture;
+}
+
+Cooker::Cooker(std::filesystem::path cacheDirectory)
+    : cacheDirectory_(std::move(cacheDirectory))
+{
+    std::filesystem::create_directories(cacheDirectory_);
+}
+
+CookedTexture Cooker::cook(const CookRequest& request, bool& cacheHit) const
+{
+    const auto content = readFile(request.source);
+    ContentHasher hasher;
+    hasher.update(cookVersion);
+    hasher.update(std::as_bytes(std::span(decoderRevision)));
+    hasher.update(request.format);
+    hasher.update(std::span<const std::byte>(content));
+    const uint64_t contentHash = hasher.hash();
+
+    const auto path = cachePath(contentHash);
+    if (auto cached = loadCached(path, contentHash)) {
+        cacheHit = true;
+        return std::move(*cached);
+    }
+    cacheHit = false;
+    auto texture = cookImage(decodeImage(content), request.format, contentHash);
+    storeCached(path, texture);
+    return texture;
+}
+
+std::size_t Cooker::removeStaleEntries(std::span<const uint64_t> usedHashes) const
+{
+    std::set<std::filesystem::path> usedPaths;
+    for (uint64_t hash : usedHashes) {
+        usedPaths.insert(cachePath(hash));
+    }
+    std::size_t removedCount = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(cacheDirectory_)) {
+        if (entry.path().extension() == ".cooked" && !usedPaths.contains(entry.path())) {
+            removedCount += std::filesystem::remove(entry.path()) ? 1u : 0u;
+        }
+    }
+    return removedCount;
+}
+
+std::filesystem::path Cooker::cachePath(uint64_t contentHash) const
+{
+    std::array<char, 17> name {};
+    static constexpr std::string_view digits = "0123456789abcdef";
+    for (std::size_t i = 0; i < 16; i++) {
+        name[i] = digits[(contentHash >> (60 - 4 * i)) & 0xf];
+    }
+    return cacheDirectory_ / (std::string(name.data()) + ".cooked");
+}
+
+} // namespace magma::cook
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <magma/asset/PackFormat.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace magma::cook {
+
+/**
+ * @brief Formats a texture can be cooked to
+ */
+enum class TextureFormat {
+    Rgba8,
+    Rgba8Srgb,
+    Bc5,
+    Bc7,
+    Bc7Srgb,
+};
+
+/**
+ * @brief Parses a format name as accepted on the command line (e.g. "bc7-srgb")
+ */
+std::optional<TextureFormat> parseTextureFormat(std::string_view name);
+
+/**
+ * @brief Converts value to uint32_t, throwing std::runtime_error mentioning what if it does not fit
+ */
+uint32_t toUint32(uint64_t value, std::string_view what);
+
+/**
+ * @brief Returns a unique path next to path, to write it atomically by renaming once complete
+ *
+ * The name has a random suffix, so that neither threads nor processes writing the same path can
+ * clobber each other's partially written file.
+ */
+std::filesystem::path temporaryPathFor(const std::filesystem::path& path);
+
+/**
+ * @brief Texture to cook and how to cook it
+ */
+struct CookRequest {
+    std::filesystem::path source;
+    TextureFormat format;
+};
+
+/**
+ * @brief Result of cooking a texture, ready to be written in a pack
+ */
+struct CookedTexture {
+    uint64_t contentHash = 0;
+    uint32_t format = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    /**
+     * @brief One region per mip level, offsets relative to the start of data
+     */
+    std::vector<asset::RegionEntry> regions;
+    std::vector<std::byte> data;
+};
+
+/**
+ * @brief Cooks textures, reusing results cached by content hash from previous runs
+ *
+ * Cooking a texture is stateless, so a single Cooker can be used from several threads.
+ */
+class Cooker {
+public:
+    explicit Cooker(std::filesystem::path cacheDirectory);
+
+    /**
+     * @brief Cooks the texture described by request, throwing std::runtime_error on failure
+     *
+     * @param cacheHit set to true if the result was loaded from the cache
+     */
+    CookedTexture cook(const CookRequest& request, bool& cacheHit) const;
+
+    /**
+     * @brief Removes the cached textures whose hash is not in usedHashes, returning their count
+     *
+     * Meant to be called once the pack is written, so that the cache only holds what the pack
+     * references. The cache directory must thus not be shared between several packs.
+     */
+    std::size_t removeStaleEntries(std::span<const uint64_t> usedHashes) const;
+
+private:
+    [[nodiscard]] std::filesystem::path cachePath(uint64_t contentHash) const;
+
+    std::filesystem::path cacheDirectory_;
+};
+
+} // namespace magma::cook
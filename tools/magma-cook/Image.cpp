@@ -0,0 +1,114 @@
+#include "Image.hpp"
+
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_NO_STDIO
+#define STBI_FAILURE_USERMSG
+#include <stb_image.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace magma::cook {
+
+static float srgbToLinear(float value)
+{
+    return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+static float linearToSrgb(float value)
+{
+    return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+}
+
+static uint8_t toUnorm8(float value)
+{
+    return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+Rgba8Image decodeImage(std::span<const std::byte> fileContent)
+{
+    using StbiImage = std::unique_ptr<stbi_uc, decltype(&stbi_image_free)>;
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    if (fileContent.size() > std::size_t(std::numeric_limits<int>::max())) {
+        throw std::runtime_error("image file is too large");
+    }
+    // Check the extent from the header before decoding, to avoid allocating oversized images
+    if (stbi_info_from_memory(
+            reinterpret_cast<const stbi_uc*>(fileContent.data()),
+            static_cast<int>(fileContent.size()),
+            &width,
+            &height,
+            &channels)
+        && (uint32_t(width) > maxImageExtent || uint32_t(height) > maxImageExtent)) {
+        throw std::runtime_error(
+            "image of " + std::to_string(width) + "x" + std::to_string(height)
+            + " exceeds the maximum extent of " + std::to_string(maxImageExtent));
+    }
+    StbiImage texels(
+        stbi_load_from_memory(
+            reinterpret_cast<const stbi_uc*>(fileContent.data()),
+            static_cast<int>(fileContent.size()),
+            &width,
+            &height,
+            &channels,
+            STBI_rgb_alpha),
+        &stbi_image_free);
+    if (!texels) {
+        throw std::runtime_error(std::string("cannot decode image: ") + stbi_failure_reason());
+    }
+    return Rgba8Image {
+        .width = uint32_t(width),
+        .height = uint32_t(height),
+        .texels = { texels.get(), texels.get() + std::size_t(width) * std::size_t(height) * 4 },
+    };
+}
+
+Rgba32fImage toRgba32f(const Rgba8Image& image, bool srgb)
+{
+    std::array<float, 256> colorLut;
+    std::array<float, 256> alphaLut;
+    for (std::size_t i = 0; i < 256; i++) {
+        alphaLut[i] = float(i) / 255.0f;
+        colorLut[i] = srgb ? srgbToLinear(alphaLut[i]) : alphaLut[i];
+    }
+    Rgba32fImage result {
+        .width = image.width,
+        .height = image.height,
+        .texels = std::vector<float>(image.texels.size()),
+    };
+    for (std::size_t i = 0; i < image.texels.size(); i += 4) {
+        result.texels[i + 0] = colorLut[image.texels[i + 0]];
+        result.texels[i + 1] = colorLut[image.texels[i + 1]];
+        result.texels[i + 2] = colorLut[image.texels[i + 2]];
+        result.texels[i + 3] = alphaLut[image.texels[i + 3]];
+    }
+    return result;
+}
+
+Rgba8Image toRgba8(const Rgba32fImage& image, bool srgb)
+{
+    const auto encodeColor = [srgb](float value) {
+        return toUnorm8(srgb ? linearToSrgb(std::max(value, 0.0f)) : value);
+    };
+    Rgba8Image result {
+        .width = image.width,
+        .height = image.height,
+        .texels = std::vector<uint8_t>(image.texels.size()),
+    };
+    for (std::size_t i = 0; i < image.texels.size(); i += 4) {
+        result.texels[i + 0] = encodeColor(image.texels[i + 0]);
+        result.texels[i + 1] = encodeColor(image.texels[i + 1]);
+        result.texels[i + 2] = encodeColor(image.texels[i + 2]);
+        result.texels[i + 3] = toUnorm8(image.texels[i + 3]);
+    }
+    return result;
+}
+
+} // namespace magma::cook
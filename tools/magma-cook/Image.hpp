@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace magma::cook {
+
+/**
+ * @brief 8-bit RGBA image, as stored in the asset pack or fed to the block compressors
+ */
+struct Rgba8Image {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> texels;
+};
+
+/**
+ * @brief 32-bit float RGBA image in linear space, used to filter mip levels
+ */
+struct Rgba32fImage {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<float> texels;
+};
+
+/**
+ * @brief Largest width or height accepted for a source image
+ *
+ * Matches the maxImageDimension2D of most desktop GPUs, and keeps the size of any mip level below
+ * 4 GiB so that it fits the 32-bit fields of the asset pack.
+ */
+inline constexpr uint32_t maxImageExtent = 16384;
+
+/**
+ * @brief Decodes an image file (PNG, JPEG, TGA, BMP...) into RGBA, throwing on failure or if the
+ * image is larger than maxImageExtent
+ */
+Rgba8Image decodeImage(std::span<const std::byte> fileContent);
+
+/**
+ * @brief Converts to float, decoding sRGB to linear if srgb is set
+ */
+Rgba32fImage toRgba32f(const Rgba8Image& image, bool srgb);
+
+/**
+ * @brief Converts to 8-bit, encoding linear to sRGB if srgb is set (alpha is always linear)
+ */
+Rgba8Image toRgba8(const Rgba32fImage& image, bool srgb);
+
+} // namespace magma::cook
@@ -0,0 +1,189 @@
+#include "Cooker.hpp"
+#include "PackWriter.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdlib>
+#include <exception>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace magma::cook {
+
+static constexpr std::string_view usage = R"(
+Usage: magma-cook [options] [--format <format>] <texture>...
+
+Cooks textures into an asset pack ready to be memory-mapped and uploaded as is.
+
+Options:
+  -o, --output <file>   Asset pack to write (required)
+  --cache-dir <dir>     Directory caching cooked textures by content hash, entries not
+                        used by the pack are removed so it must not be shared between
+                        packs (default: <file>.cache)
+  -j, --jobs <count>    Number of textures cooked in parallel
+                        (default: number of hardware threads)
+  --format <format>     Format of the textures listed after this option, one of
+                        rgba8, rgba8-srgb, bc5, bc7, bc7-srgb (default: bc7-srgb)
+  -v, --verbose         Log each texture cooked
+  -h, --help            Print this message
+)";
+
+struct Options {
+    std::filesystem::path output;
+    std::filesystem::path cacheDirectory;
+    unsigned jobs = std::max(std::thread::hardware_concurrency(), 1u);
+    bool verbose = false;
+    std::vector<CookRequest> requests;
+};
+
+static Options parseOptions(int argc, char** argv)
+{
+    Options options;
+    TextureFormat format = TextureFormat::Bc7Srgb;
+    const std::vector<std::string_view> args(argv + 1, argv + argc);
+    for (auto arg = args.begin(); arg != args.end(); ++arg) {
+        const auto value = [&]() {
+            if (std::next(arg) == args.end()) {
+                throw std::runtime_error("missing value for option " + std::string(*arg));
+            }
+            return *++arg;
+        };
+        if (*arg == "-h" || *arg == "--help") {
+            fmt::print("{}", usage.substr(1));
+            std::exit(EXIT_SUCCESS);
+        } else if (*arg == "-o" || *arg == "--output") {
+            options.output = value();
+        } else if (*arg == "--cache-dir") {
+            options.cacheDirectory = value();
+        } else if (*arg == "-j" || *arg == "--jobs") {
+            const auto jobs = value();
+            const auto* jobsEnd = jobs.data() + jobs.size();
+            const auto [end, error] = std::from_chars(jobs.data(), jobsEnd, options.jobs);
+            if (error != std::errc {} || end != jobsEnd || options.jobs == 0) {
+                throw std::runtime_error("invalid job count " + std::string(jobs));
+            }
+        } else if (*arg == "--format") {
+            const auto name = value();
+            const auto parsedFormat = parseTextureFormat(name);
+            if (!parsedFormat) {
+                throw std::runtime_error("unknown format " + std::string(name));
+            }
+            format = *parsedFormat;
+        } else if (*arg == "-v" || *arg == "--verbose") {
+            options.verbose = true;
+        } else if (arg->starts_with('-')) {
+            throw std::runtime_error("unknown option " + std::string(*arg));
+        } else {
+            options.requests.push_back(CookRequest { .source = *arg, .format = format });
+        }
+    }
+    if (options.output.empty()) {
+        throw std::runtime_error("no output specified");
+    }
+    if (options.cacheDirectory.empty()) {
+        options.cacheDirectory = options.output;
+        options.cacheDirectory += ".cache";
+    }
+    return options;
+}
+
+/**
+ * @brief Cooks all the requests using a pool of worker threads, each picking the next request
+ */
+static std::vector<PackedTexture> cookAll(const Cooker& cooker, const Options& options)
+{
+    const auto& requests = options.requests;
+    std::vector<PackedTexture> textures(requests.size());
+    std::vector<std::exception_ptr> errors(requests.size());
+    std::atomic_size_t nextRequest = 0;
+    std::atomic_size_t cacheHits = 0;
+    const auto work = [&]() {
+        for (std::size_t i = nextRequest++; i < requests.size(); i = nextRequest++) {
+            try {
+                bool cacheHit = false;
+                textures[i].name = requests[i].source.stem().string();
+                textures[i].texture = cooker.cook(requests[i], cacheHit);
+                cacheHits += cacheHit;
+                spdlog::debug(
+                    "{} {} ({}x{}, {} mip levels)",
+                    cacheHit ? "Reused" : "Cooked",
+                    requests[i].source.string(),
+                    textures[i].texture.width,
+                    textures[i].texture.height,
+                    textures[i].texture.regions.size());
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+    {
+        std::vector<std::jthread> workers;
+        const auto workerCount = std::min<std::size_t>(options.jobs, requests.size());
+        for (std::size_t i = 1; i < workerCount; i++) {
+            workers.emplace_back(work);
+        }
+        work();
+    }
+    for (std::size_t i = 0; i < requests.size(); i++) {
+        if (errors[i]) {
+            try {
+                std::rethrow_exception(errors[i]);
+            } catch (const std::exception& e) {
+                throw std::runtime_error(requests[i].source.string() + ": " + e.what());
+            }
+        }
+    }
+    spdlog::info(
+        "Cooked {} textures ({} reused from cache)",
+        requests.size(),
+        cacheHits.load());
+    return textures;
+}
+
+/**
+ * @brief Textures are named after their file name without extension, which must be unique
+ */
+static void checkUniqueNames(const std::vector<CookRequest>& requests)
+{
+    std::set<std::string> names;
+    for (const auto& request : requests) {
+        if (!names.insert(request.source.stem().string()).second) {
+            throw std::runtime_error(
+                "several textures are named " + request.source.stem().string());
+        }
+    }
+}
+
+} // namespace magma::cook
+
+int main(int argc, char** argv)
+{
+    using namespace magma::cook;
+    try {
+        const auto options = parseOptions(argc, argv);
+        if (options.verbose) {
+            spdlog::set_level(spdlog::level::debug);
+        }
+        checkUniqueNames(options.requests);
+        const Cooker cooker(options.cacheDirectory);
+        const auto textures = cookAll(cooker, options);
+        writePack(options.output, textures);
+        std::vector<uint64_t> usedHashes;
+        for (const auto& texture : textures) {
+            usedHashes.push_back(texture.texture.contentHash);
+        }
+        const auto removedCount = cooker.removeStaleEntries(usedHashes);
+        spdlog::debug("Removed {} stale cache entries", removedCount);
+    } catch (const std::exception& e) {
+        spdlog::error("magma-cook: {}", e.what());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
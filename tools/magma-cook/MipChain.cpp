@@ -0,0 +1,154 @@
+#include "MipChain.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define MAGMA_COOK_SSE
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define MAGMA_COOK_NEON
+#endif
+
+namespace magma::cook {
+
+/**
+ * @brief Source texels contributing to a destination texel along one axis, and their weights
+ */
+struct Footprint {
+    uint32_t first;
+    uint32_t count;
+    std::array<float, 3> weights;
+};
+
+/**
+ * @brief Computes the footprint of each destination texel when reducing size texels to half
+ *
+ * Even sizes use a 2-tap box filter. Odd sizes 2n+1 use 3 taps weighted (n-x, n, x+1)/(2n+1), so
+ * that each source texel contributes the same total weight to the destination and the last texel
+ * is not dropped.
+ */
+static std::vector<Footprint> computeFootprints(uint32_t size)
+{
+    const uint32_t half = std::max(size / 2, 1u);
+    std::vector<Footprint> footprints(half);
+    for (uint32_t x = 0; x < half; x++) {
+        if (size == 1) {
+            footprints[x] = { .first = 0, .count = 1, .weights = { 1.0f, 0.0f, 0.0f } };
+        } else if (size % 2 == 0) {
+            footprints[x] = { .first = 2 * x, .count = 2, .weights = { 0.5f, 0.5f, 0.0f } };
+        } else {
+            const float scale = 1.0f / float(size);
+            footprints[x] = {
+                .first = 2 * x,
+                .count = 3,
+                .weights = { float(half - x) * scale, float(half) * scale, float(x + 1) * scale },
+            };
+        }
+    }
+    return footprints;
+}
+
+/**
+ * @brief RGBA texel held in a single SIMD vector
+ */
+class Texel {
+#if defined(MAGMA_COOK_SSE)
+    using Value = __m128;
+#elif defined(MAGMA_COOK_NEON)
+    using Value = float32x4_t;
+#else
+    using Value = std::array<float, 4>;
+#endif
+
+public:
+    static Texel zero()
+    {
+#if defined(MAGMA_COOK_SSE)
+        return Texel(_mm_setzero_ps());
+#elif defined(MAGMA_COOK_NEON)
+        return Texel(vdupq_n_f32(0.0f));
+#else
+        return Texel(Value {});
+#endif
+    }
+
+    /**
+     * @brief Accumulates the texel at src weighted by weight
+     */
+    void addWeighted(const float* src, float weight)
+    {
+#if defined(MAGMA_COOK_SSE)
+        value_ = _mm_add_ps(value_, _mm_mul_ps(_mm_loadu_ps(src), _mm_set1_ps(weight)));
+#elif defined(MAGMA_COOK_NEON)
+        value_ = vmlaq_n_f32(value_, vld1q_f32(src), weight);
+#else
+        for (std::size_t channel = 0; channel < 4; channel++) {
+            value_[channel] += src[channel] * weight;
+        }
+#endif
+    }
+
+    void store(float* dst) const
+    {
+#if defined(MAGMA_COOK_SSE)
+        _mm_storeu_ps(dst, value_);
+#elif defined(MAGMA_COOK_NEON)
+        vst1q_f32(dst, value_);
+#else
+        std::copy(value_.begin(), value_.end(), dst);
+#endif
+    }
+
+private:
+    explicit Texel(Value value)
+        : value_(value)
+    {
+    }
+
+    Value value_;
+};
+
+Rgba32fImage downsample(const Rgba32fImage& image)
+{
+    const auto columns = computeFootprints(image.width);
+    const auto rows = computeFootprints(image.height);
+    const auto width = uint32_t(columns.size());
+    const auto height = uint32_t(rows.size());
+    Rgba32fImage result {
+        .width = width,
+        .height = height,
+        .texels = std::vector<float>(std::size_t(width) * height * 4),
+    };
+    for (uint32_t y = 0; y < height; y++) {
+        const auto& row = rows[y];
+        float* dst = &result.texels[std::size_t(y) * width * 4];
+        for (uint32_t x = 0; x < width; x++, dst += 4) {
+            const auto& column = columns[x];
+            auto texel = Texel::zero();
+            for (uint32_t i = 0; i < row.count; i++) {
+                const float* src
+                    = &image.texels[(std::size_t(row.first + i) * image.width + column.first) * 4];
+                for (uint32_t j = 0; j < column.count; j++) {
+                    texel.addWeighted(src + j * 4, row.weights[i] * column.weights[j]);
+                }
+            }
+            texel.store(dst);
+        }
+    }
+    return result;
+}
+
+std::vector<Rgba32fImage> buildMipChain(Rgba32fImage image)
+{
+    std::vector<Rgba32fImage> mips;
+    mips.push_back(std::move(image));
+    while (mips.back().width > 1 || mips.back().height > 1) {
+        mips.push_back(downsample(mips.back()));
+    }
+    return mips;
+}
+
+} // namespace magma::cook
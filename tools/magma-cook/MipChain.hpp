@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Image.hpp"
+
+#include <vector>
+
+namespace magma::cook {
+
+/**
+ * @brief Halves each dimension of image (rounding down, down to 1)
+ *
+ * Even dimensions use a box filter over 2 texels. Odd dimensions use a filter over 3 texels whose
+ * weights conserve the energy of the source, so that the last row or column is not dropped.
+ */
+Rgba32fImage downsample(const Rgba32fImage& image);
+
+/**
+ * @brief Builds the full mip chain of image, from image itself down to the 1x1 level
+ */
+std::vector<Rgba32fImage> buildMipChain(Rgba32fImage image);
+
+} // namespace magma::cook
@@ -0,0 +1,81 @@
+#include "PackWriter.hpp"
+
+#include <fstream>
+#include <stdexcept>
+
+namespace magma::cook {
+
+static uint64_t alignUp(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+void writePack(const std::filesystem::path& path, const std::vector<PackedTexture>& textures)
+{
+    std::vector<asset::TextureEntry> textureEntries;
+    std::vector<asset::RegionEntry> regionEntries;
+    std::string names;
+    for (const auto& [name, texture] : textures) {
+        textureEntries.push_back(asset::TextureEntry {
+            .contentHash = texture.contentHash,
+            .dataOffset = 0,
+            .dataSize = texture.data.size(),
+            .nameOffset = toUint32(names.size(), "names size"),
+            .nameSize = toUint32(name.size(), "texture name size"),
+            .format = texture.format,
+            .width = texture.width,
+            .height = texture.height,
+            .mipLevels = toUint32(texture.regions.size(), "mip level count"),
+            .firstRegion = toUint32(regionEntries.size(), "region index"),
+            .regionCount = toUint32(texture.regions.size(), "region count"),
+        });
+        regionEntries.insert(regionEntries.end(), texture.regions.begin(), texture.regions.end());
+        names += name;
+    }
+
+    asset::PackHeader header {
+        .magic = asset::packMagic,
+        .version = asset::packVersion,
+        .textureCount = toUint32(textureEntries.size(), "texture count"),
+        .regionCount = toUint32(regionEntries.size(), "region count"),
+        .namesOffset = sizeof(asset::PackHeader)
+            + textureEntries.size() * sizeof(asset::TextureEntry)
+            + regionEntries.size() * sizeof(asset::RegionEntry),
+        .dataOffset = 0,
+    };
+    header.dataOffset = alignUp(header.namesOffset + names.size(), asset::dataAlignment);
+    uint64_t dataEnd = header.dataOffset;
+    for (auto& entry : textureEntries) {
+        entry.dataOffset = alignUp(dataEnd, asset::dataAlignment);
+        dataEnd = entry.dataOffset + entry.dataSize;
+    }
+
+    const auto temporaryPath = temporaryPathFor(path);
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        const auto write = [&file](const void* data, std::size_t size) {
+            file.write(static_cast<const char*>(data), std::streamsize(size));
+        };
+        const auto padTo = [&file](uint64_t offset) {
+            while (uint64_t(file.tellp()) < offset) {
+                file.put('\0');
+            }
+        };
+        write(&header, sizeof(header));
+        write(textureEntries.data(), textureEntries.size() * sizeof(asset::TextureEntry));
+        write(regionEntries.data(), regionEntries.size() * sizeof(asset::RegionEntry));
+        write(names.data(), names.size());
+        // Pad even if there is no texture, so that dataOffset always lies within the pack
+        padTo(header.dataOffset);
+        for (std::size_t i = 0; i < textures.size(); i++) {
+            padTo(textureEntries[i].dataOffset);
+            write(textures[i].texture.data.data(), textures[i].texture.data.size());
+        }
+        if (!file) {
+            throw std::runtime_error("cannot write " + temporaryPath.string());
+        }
+    }
+    std::filesystem::rename(temporaryPath, path);
+}
+
+} // namespace magma::cook
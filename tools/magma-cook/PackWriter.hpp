@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Cooker.hpp"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace magma::cook {
+
+/**
+ * @brief Texture to write in a pack, under the given name
+ */
+struct PackedTexture {
+    std::string name;
+    CookedTexture texture;
+};
+
+/**
+ * @brief Writes textures into an asset pack at path, throwing std::runtime_error on failure
+ *
+ * The textures are stored in the given order. The pack is written atomically: path is either
+ * left untouched or replaced by a complete pack.
+ */
+void writePack(const std::filesystem::path& path, const std::vector<PackedTexture>& textures);
+
+} // namespace magma::cook